@@ -0,0 +1,68 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "alert_module.h"
+
+/* Load generator for the alert dispatcher. Start ./alert_sink first, then
+   submit a burst of CRITICAL alerts (optionally paced) and report the
+   submit rate, sustained dispatch rate and peak queue depth.
+   Usage: ./alert_load [alerts] [paceNs] [socketPath] */
+
+#define LOAD_ALERTS 1000000L
+#define LOAD_QUEUE_CAPACITY 65536
+#define LOAD_CONNECT_WAIT_US 300000
+#define LOAD_DRAIN_TIMEOUT_NS 10000000000LL
+
+int main(int argc, char *argv[]) {
+    long alerts = (argc > 1) ? atol(argv[1]) : LOAD_ALERTS;
+    long long paceNs = (argc > 2) ? atoll(argv[2]) : 0;
+    const char *socketPath = (argc > 3) ? argv[3] : ALERT_SOCKET_PATH;
+    if (alerts <= 0 || paceNs < 0) {
+        printf("Usage: %s [alerts] [paceNs] [socketPath]\n", argv[0]);
+        return 1;
+    }
+
+    AlertDispatcher *dispatcher = createAlertDispatcher(socketPath, LOAD_QUEUE_CAPACITY);
+    if (dispatcher == NULL) {
+        printf("Error: Could not create alert dispatcher\n");
+        return 1;
+    }
+    usleep(LOAD_CONNECT_WAIT_US);   /* let the I/O thread reach the sink */
+    if (getAlertStats(dispatcher).connects == 0) {
+        printf("Warning: No sink on %s, alerts will queue and drop\n", socketPath);
+    }
+
+    AlertEvent alert = {{0, 130, 170, 85}, CRITICAL, 2, 50, 0};
+    long accepted = 0;
+    long long start = alertClockNs();
+    for (long i = 0; i < alerts; i++) {
+        alert.reading.patientId = (int)(i % MAX_PATIENTS);
+        accepted += submitAlert(dispatcher, alert);
+        if (paceNs > 0) {
+            long long until = alertClockNs() + paceNs;
+            while (alertClockNs() < until);
+        }
+    }
+    long long submitted = alertClockNs();
+
+    /* Wait for the queue to drain so the dispatch rate covers every send */
+    AlertStats stats = getAlertStats(dispatcher);
+    while (stats.queued > 0 && stats.connects > 0 &&
+           alertClockNs() - submitted < LOAD_DRAIN_TIMEOUT_NS) {
+        usleep(1000);
+        stats = getAlertStats(dispatcher);
+    }
+    long long drained = alertClockNs();
+
+    printf("\n[Load] %ld alerts, pace %lld ns\n", alerts, paceNs);
+    printf("[Load] Submit: %.2f M alerts/s (%ld accepted, %ld dropped)\n",
+           alerts / ((submitted - start) / 1e9) / 1e6, accepted, stats.dropped);
+    printf("[Load] Dispatch: %.2f M alerts/s sustained, %ld sent in %ld batches\n",
+           stats.sent / ((drained - start) / 1e9) / 1e6, stats.sent, stats.batches);
+    printf("[Load] Peak queue depth: %d of %d | would-block: %ld\n\n",
+           stats.maxQueued, LOAD_QUEUE_CAPACITY, stats.wouldBlock);
+
+    destroyAlertDispatcher(dispatcher);
+    return 0;
+}
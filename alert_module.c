@@ -0,0 +1,417 @@
+#define _GNU_SOURCE
+#include "alert_module.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+long long alertClockNs(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+static void putU16(unsigned char *p, unsigned long value) {
+    p[0] = (unsigned char)(value & 0xFF);
+    p[1] = (unsigned char)((value >> 8) & 0xFF);
+}
+
+static void putU32(unsigned char *p, unsigned long value) {
+    putU16(p, value & 0xFFFF);
+    putU16(p + 2, (value >> 16) & 0xFFFF);
+}
+
+static void putU64(unsigned char *p, unsigned long long value) {
+    putU32(p, (unsigned long)(value & 0xFFFFFFFFULL));
+    putU32(p + 4, (unsigned long)(value >> 32));
+}
+
+static unsigned long getU16(const unsigned char *p) {
+    return (unsigned long)p[0] | ((unsigned long)p[1] << 8);
+}
+
+static unsigned long getU32(const unsigned char *p) {
+    return getU16(p) | (getU16(p + 2) << 16);
+}
+
+static unsigned long long getU64(const unsigned char *p) {
+    return (unsigned long long)getU32(p) | ((unsigned long long)getU32(p + 4) << 32);
+}
+
+/* Wire layout (little-endian, ALERT_WIRE_SIZE bytes):
+   0 magic u16 | 2 version u8 | 3 priority u8 | 4 patientId u32 |
+   8 heartRate u16 | 10 bloodPressure u16 | 12 spo2 u8 | 13 hospitalId u8 |
+   14 distance u16 (x10 km, saturating) | 16 createdNs u64 */
+void serializeAlert(const AlertEvent *alert, unsigned char *buffer) {
+    int distance = alert->distance;
+    if (distance < 0) distance = 0;
+    if (distance > 0xFFFF) distance = 0xFFFF;
+
+    putU16(buffer, ALERT_WIRE_MAGIC);
+    buffer[2] = ALERT_WIRE_VERSION;
+    buffer[3] = (unsigned char)alert->priority;
+    putU32(buffer + 4, (unsigned long)alert->reading.patientId);
+    putU16(buffer + 8, (unsigned long)alert->reading.heartRate);
+    putU16(buffer + 10, (unsigned long)alert->reading.bloodPressure);
+    buffer[12] = (unsigned char)alert->reading.spo2;
+    buffer[13] = (unsigned char)alert->hospitalId;
+    putU16(buffer + 14, (unsigned long)distance);
+    putU64(buffer + 16, (unsigned long long)alert->createdNs);
+}
+
+int deserializeAlert(const unsigned char *buffer, AlertEvent *alert) {
+    if (buffer == NULL || alert == NULL) return 0;
+    if (getU16(buffer) != ALERT_WIRE_MAGIC || buffer[2] != ALERT_WIRE_VERSION) return 0;
+
+    alert->priority = (PriorityLevel)buffer[3];
+    alert->reading.patientId = (int)getU32(buffer + 4);
+    alert->reading.heartRate = (int)getU16(buffer + 8);
+    alert->reading.bloodPressure = (int)getU16(buffer + 10);
+    alert->reading.spo2 = buffer[12];
+    alert->hospitalId = buffer[13];
+    alert->distance = (int)getU16(buffer + 14);
+    alert->createdNs = (long long)getU64(buffer + 16);
+    return 1;
+}
+
+/* Returns 1 when connected, 0 if the sink exists but its backlog is full
+   (retry shortly), -1 if no sink is listening. */
+static int connectSink(AlertDispatcher *dispatcher) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, dispatcher->socketPath, sizeof(address.sun_path) - 1);
+
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) < 0 && errno != EINPROGRESS) {
+        int busy = (errno == EAGAIN);
+        close(fd);
+        return busy ? 0 : -1;
+    }
+
+    /* No EPOLLOUT until a write would block; EPOLLHUP/EPOLLERR are always reported */
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.data.fd = fd;
+    if (epoll_ctl(dispatcher->epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    dispatcher->socketFd = fd;
+    pthread_mutex_lock(&dispatcher->lock);
+    dispatcher->stats.connects++;
+    pthread_mutex_unlock(&dispatcher->lock);
+    return 1;
+}
+
+static void closeSink(AlertDispatcher *dispatcher) {
+    epoll_ctl(dispatcher->epollFd, EPOLL_CTL_DEL, dispatcher->socketFd, NULL);
+    close(dispatcher->socketFd);
+    dispatcher->socketFd = -1;
+
+    /* A partially written record is resent whole on the next connection */
+    dispatcher->batchOffset -= dispatcher->batchOffset % ALERT_WIRE_SIZE;
+}
+
+static void setWriteInterest(AlertDispatcher *dispatcher, int enable) {
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = enable ? EPOLLOUT : 0;
+    event.data.fd = dispatcher->socketFd;
+    epoll_ctl(dispatcher->epollFd, EPOLL_CTL_MOD, dispatcher->socketFd, &event);
+}
+
+static void fillBatch(AlertDispatcher *dispatcher) {
+    int count = 0;
+
+    pthread_mutex_lock(&dispatcher->lock);
+    while (dispatcher->size > 0 && count < ALERT_BATCH_SIZE) {
+        serializeAlert(&dispatcher->ring[dispatcher->front],
+                       dispatcher->batch + count * ALERT_WIRE_SIZE);
+        dispatcher->front = (dispatcher->front + 1) % dispatcher->capacity;
+        dispatcher->size--;
+        count++;
+    }
+    pthread_mutex_unlock(&dispatcher->lock);
+
+    dispatcher->batchLength = count * ALERT_WIRE_SIZE;
+    dispatcher->batchOffset = 0;
+}
+
+/* Returns 1 when the batch is fully sent, 0 if the socket would block,
+   -1 if the connection failed. */
+static int flushBatch(AlertDispatcher *dispatcher) {
+    while (dispatcher->batchOffset < dispatcher->batchLength) {
+        ssize_t written = send(dispatcher->socketFd,
+                               dispatcher->batch + dispatcher->batchOffset,
+                               dispatcher->batchLength - dispatcher->batchOffset,
+                               MSG_NOSIGNAL);
+        if (written > 0) {
+            dispatcher->batchOffset += (int)written;
+        } else if (written < 0 && errno == EINTR) {
+            continue;
+        } else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            pthread_mutex_lock(&dispatcher->lock);
+            dispatcher->stats.wouldBlock++;
+            pthread_mutex_unlock(&dispatcher->lock);
+            return 0;
+        } else {
+            return -1;
+        }
+    }
+
+    pthread_mutex_lock(&dispatcher->lock);
+    dispatcher->stats.sent += dispatcher->batchLength / ALERT_WIRE_SIZE;
+    dispatcher->stats.batches++;
+    pthread_mutex_unlock(&dispatcher->lock);
+
+    dispatcher->batchLength = 0;
+    dispatcher->batchOffset = 0;
+    return 1;
+}
+
+static void *dispatchLoop(void *arg) {
+    AlertDispatcher *dispatcher = (AlertDispatcher*)arg;
+    long long nextConnectNs = 0;
+    long long deadlineNs = 0;
+    int writeBlocked = 0;
+    int sinkSeen = 0;
+
+    while (1) {
+        pthread_mutex_lock(&dispatcher->lock);
+        int running = dispatcher->running;
+        int pending = dispatcher->size;
+        pthread_mutex_unlock(&dispatcher->lock);
+
+        long long now = alertClockNs();
+        if (!running) {
+            if (deadlineNs == 0) {
+                deadlineNs = now + ALERT_FLUSH_TIMEOUT_MS * 1000000LL;
+            }
+            /* Only wait for a flush if a sink has ever answered */
+            if ((pending == 0 && dispatcher->batchLength == 0) || !sinkSeen ||
+                now >= deadlineNs) break;
+        }
+
+        if (dispatcher->socketFd < 0 && now >= nextConnectNs) {
+            int result = connectSink(dispatcher);
+            if (result >= 0) sinkSeen = 1;
+            if (result == 0) {
+                nextConnectNs = now + ALERT_BUSY_RETRY_MS * 1000000LL;
+            } else if (result < 0) {
+                nextConnectNs = now + ALERT_RECONNECT_MS * 1000000LL;
+            }
+            writeBlocked = 0;
+        }
+
+        if (dispatcher->socketFd >= 0 && !writeBlocked) {
+            if (dispatcher->batchLength == 0 && pending > 0) {
+                fillBatch(dispatcher);
+            }
+            if (dispatcher->batchLength > 0) {
+                int result = flushBatch(dispatcher);
+                if (result > 0) continue;
+                if (result == 0) {
+                    writeBlocked = 1;
+                    setWriteInterest(dispatcher, 1);
+                } else {
+                    closeSink(dispatcher);
+                    nextConnectNs = now + ALERT_RECONNECT_MS * 1000000LL;
+                }
+            }
+        }
+
+        int timeout = -1;
+        if (dispatcher->socketFd < 0) {
+            long long untilConnectMs = (nextConnectNs - now) / 1000000LL;
+            timeout = (untilConnectMs > 0) ? (int)untilConnectMs : 0;
+        }
+        if (!running && (timeout < 0 || timeout > 10)) timeout = 10;
+
+        struct epoll_event events[4];
+        int ready = epoll_wait(dispatcher->epollFd, events, 4, timeout);
+        for (int i = 0; i < ready; i++) {
+            if (events[i].data.fd == dispatcher->wakeFd) {
+                uint64_t value;
+                if (read(dispatcher->wakeFd, &value, sizeof(value)) < 0) {
+                    /* Already drained */
+                }
+            } else if (events[i].data.fd == dispatcher->socketFd) {
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    closeSink(dispatcher);
+                    nextConnectNs = alertClockNs() + ALERT_RECONNECT_MS * 1000000LL;
+                    writeBlocked = 0;
+                } else if (events[i].events & EPOLLOUT) {
+                    setWriteInterest(dispatcher, 0);
+                    writeBlocked = 0;
+                }
+            }
+        }
+    }
+
+    /* Whatever could not be delivered before shutdown is reported as
+       undelivered, separately from queue-full drops */
+    int unsent = (dispatcher->batchLength -
+                  (dispatcher->batchOffset - dispatcher->batchOffset % ALERT_WIRE_SIZE)) /
+                 ALERT_WIRE_SIZE;
+    pthread_mutex_lock(&dispatcher->lock);
+    dispatcher->stats.undelivered += dispatcher->size + unsent;
+    dispatcher->size = 0;
+    pthread_mutex_unlock(&dispatcher->lock);
+
+    if (dispatcher->socketFd >= 0) {
+        closeSink(dispatcher);
+    }
+    return NULL;
+}
+
+static void releaseDispatcher(AlertDispatcher *dispatcher) {
+    if (dispatcher->epollFd >= 0) close(dispatcher->epollFd);
+    if (dispatcher->wakeFd >= 0) close(dispatcher->wakeFd);
+    pthread_mutex_destroy(&dispatcher->lock);
+    free(dispatcher->ring);
+    free(dispatcher);
+}
+
+AlertDispatcher* createAlertDispatcher(const char *socketPath, int capacity) {
+    if (socketPath == NULL || capacity <= 0) {
+        printf("Error: Alert dispatcher needs a socket path and positive capacity\n");
+        return NULL;
+    }
+
+    AlertDispatcher *dispatcher = (AlertDispatcher*)calloc(1, sizeof(AlertDispatcher));
+    if (dispatcher == NULL) {
+        printf("Error: Memory allocation failed for alert dispatcher\n");
+        return NULL;
+    }
+
+    dispatcher->wakeFd = -1;
+    dispatcher->epollFd = -1;
+    dispatcher->socketFd = -1;
+    pthread_mutex_init(&dispatcher->lock, NULL);
+
+    dispatcher->ring = (AlertEvent*)malloc(capacity * sizeof(AlertEvent));
+    if (dispatcher->ring == NULL) {
+        printf("Error: Memory allocation failed for alert queue\n");
+        releaseDispatcher(dispatcher);
+        return NULL;
+    }
+
+    dispatcher->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    dispatcher->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (dispatcher->wakeFd < 0 || dispatcher->epollFd < 0) {
+        printf("Error: Could not create alert event descriptors\n");
+        releaseDispatcher(dispatcher);
+        return NULL;
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = dispatcher->wakeFd;
+    if (epoll_ctl(dispatcher->epollFd, EPOLL_CTL_ADD, dispatcher->wakeFd, &event) < 0) {
+        printf("Error: Could not register alert wakeup descriptor\n");
+        releaseDispatcher(dispatcher);
+        return NULL;
+    }
+
+    strncpy(dispatcher->socketPath, socketPath, sizeof(dispatcher->socketPath) - 1);
+    dispatcher->capacity = capacity;
+    dispatcher->running = 1;
+
+    if (pthread_create(&dispatcher->thread, NULL, dispatchLoop, dispatcher) != 0) {
+        printf("Error: Could not start alert I/O thread\n");
+        releaseDispatcher(dispatcher);
+        return NULL;
+    }
+
+    printf("[Alert] Dispatching to %s (queue capacity: %d)\n", socketPath, capacity);
+    return dispatcher;
+}
+
+void destroyAlertDispatcher(AlertDispatcher *dispatcher) {
+    if (dispatcher == NULL) return;
+
+    pthread_mutex_lock(&dispatcher->lock);
+    dispatcher->running = 0;
+    pthread_mutex_unlock(&dispatcher->lock);
+
+    uint64_t one = 1;
+    if (write(dispatcher->wakeFd, &one, sizeof(one)) < 0) {
+        /* Counter saturated; the I/O thread is awake anyway */
+    }
+    pthread_join(dispatcher->thread, NULL);
+
+    displayAlertStats(dispatcher);
+    releaseDispatcher(dispatcher);
+    printf("[Alert] Destroyed\n");
+}
+
+int submitAlert(AlertDispatcher *dispatcher, AlertEvent alert) {
+    if (dispatcher == NULL) {
+        printf("[Alert] Error: Dispatcher is NULL\n");
+        return 0;
+    }
+
+    alert.createdNs = alertClockNs();
+
+    pthread_mutex_lock(&dispatcher->lock);
+    dispatcher->stats.submitted++;
+    if (dispatcher->size == dispatcher->capacity) {
+        /* Never stall triage on a slow sink: reject and account for it */
+        dispatcher->stats.dropped++;
+        pthread_mutex_unlock(&dispatcher->lock);
+        return 0;
+    }
+
+    int wasEmpty = (dispatcher->size == 0);
+    dispatcher->ring[(dispatcher->front + dispatcher->size) % dispatcher->capacity] = alert;
+    dispatcher->size++;
+    if (dispatcher->size > dispatcher->stats.maxQueued) {
+        dispatcher->stats.maxQueued = dispatcher->size;
+    }
+    pthread_mutex_unlock(&dispatcher->lock);
+
+    if (wasEmpty) {
+        uint64_t one = 1;
+        if (write(dispatcher->wakeFd, &one, sizeof(one)) < 0) {
+            /* Counter saturated; the I/O thread is awake anyway */
+        }
+    }
+    return 1;
+}
+
+AlertStats getAlertStats(AlertDispatcher *dispatcher) {
+    AlertStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (dispatcher == NULL) return stats;
+
+    pthread_mutex_lock(&dispatcher->lock);
+    stats = dispatcher->stats;
+    stats.queued = dispatcher->size;
+    pthread_mutex_unlock(&dispatcher->lock);
+    return stats;
+}
+
+void displayAlertStats(AlertDispatcher *dispatcher) {
+    if (dispatcher == NULL) {
+        printf("[Alert] Error: Dispatcher is NULL\n");
+        return;
+    }
+
+    AlertStats stats = getAlertStats(dispatcher);
+    printf("[Alert] Submitted: %ld | Sent: %ld in %ld batches | Dropped (queue full): %ld | Undelivered: %ld\n",
+           stats.submitted, stats.sent, stats.batches, stats.dropped, stats.undelivered);
+    printf("[Alert] Queued: %d (peak %d) | Would-block: %ld | Connects: %ld\n",
+           stats.queued, stats.maxQueued, stats.wouldBlock, stats.connects);
+}
@@ -0,0 +1,63 @@
+#ifndef ALERT_MODULE_H
+#define ALERT_MODULE_H
+
+#include <pthread.h>
+#include "heap_module.h"
+
+#define ALERT_SOCKET_PATH "/tmp/careconnect_alerts.sock"
+#define ALERT_WIRE_MAGIC 0xCA11
+#define ALERT_WIRE_VERSION 1
+#define ALERT_WIRE_SIZE 24
+#define ALERT_BATCH_SIZE 64
+#define ALERT_RECONNECT_MS 200
+#define ALERT_BUSY_RETRY_MS 5
+#define ALERT_FLUSH_TIMEOUT_MS 500
+
+typedef struct {
+    HealthReading reading;
+    PriorityLevel priority;
+    int hospitalId;
+    int distance;
+    long long createdNs;    /* CLOCK_MONOTONIC, stamped by submitAlert */
+} AlertEvent;
+
+typedef struct {
+    long submitted;
+    long sent;
+    long dropped;           /* rejected by submitAlert, queue full */
+    long undelivered;       /* still queued when the dispatcher shut down */
+    long batches;
+    long wouldBlock;
+    long connects;
+    int queued;
+    int maxQueued;
+} AlertStats;
+
+typedef struct {
+    AlertEvent *ring;
+    int capacity;
+    int front;
+    int size;
+    pthread_mutex_t lock;
+    pthread_t thread;
+    int running;
+    int wakeFd;
+    int epollFd;
+    int socketFd;
+    char socketPath[108];
+    unsigned char batch[ALERT_BATCH_SIZE * ALERT_WIRE_SIZE];
+    int batchLength;
+    int batchOffset;
+    AlertStats stats;
+} AlertDispatcher;
+
+AlertDispatcher* createAlertDispatcher(const char *socketPath, int capacity);
+void destroyAlertDispatcher(AlertDispatcher *dispatcher);
+int submitAlert(AlertDispatcher *dispatcher, AlertEvent alert);
+AlertStats getAlertStats(AlertDispatcher *dispatcher);
+void displayAlertStats(AlertDispatcher *dispatcher);
+long long alertClockNs(void);
+void serializeAlert(const AlertEvent *alert, unsigned char *buffer);
+int deserializeAlert(const unsigned char *buffer, AlertEvent *alert);
+
+#endif
@@ -0,0 +1,166 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "alert_module.h"
+
+/* Local test sink for the alert dispatcher. Accepts one connection at a
+   time, decodes alerts and reports sustained alerts/sec and end-to-end
+   latency (submitAlert -> decoded here, same host CLOCK_MONOTONIC). */
+
+#define SINK_BUFFER_SIZE 65536
+#define LATENCY_BINS 100000     /* 1 us bins, last bin collects >= 100 ms */
+#define REPORT_INTERVAL_NS 1000000000LL
+
+typedef struct {
+    long count;
+    long intervalCount;
+    long invalid;
+    long long firstNs;
+    long long lastNs;
+    long long intervalStartNs;
+    double latencySumUs;
+    double latencyMaxUs;
+    long *histogram;
+} SinkStats;
+
+static int latencyPercentile(const SinkStats *stats, double percentile) {
+    long target = (long)(stats->count * percentile);
+    long seen = 0;
+    for (int i = 0; i < LATENCY_BINS; i++) {
+        seen += stats->histogram[i];
+        if (seen > target) return i;
+    }
+    return LATENCY_BINS - 1;
+}
+
+static void recordAlert(SinkStats *stats, const AlertEvent *alert, long long nowNs) {
+    double latencyUs = (nowNs - alert->createdNs) / 1000.0;
+    int bin = (latencyUs < 0) ? 0 : (int)latencyUs;
+    if (bin >= LATENCY_BINS) bin = LATENCY_BINS - 1;
+
+    if (stats->count == 0) stats->firstNs = nowNs;
+    stats->lastNs = nowNs;
+    stats->count++;
+    stats->intervalCount++;
+    stats->latencySumUs += latencyUs;
+    if (latencyUs > stats->latencyMaxUs) stats->latencyMaxUs = latencyUs;
+    stats->histogram[bin]++;
+}
+
+static void reportInterval(SinkStats *stats, long long nowNs) {
+    if (nowNs - stats->intervalStartNs < REPORT_INTERVAL_NS) return;
+
+    double seconds = (nowNs - stats->intervalStartNs) / 1e9;
+    printf("[Sink] %.0f alerts/s | total %ld\n", stats->intervalCount / seconds, stats->count);
+    stats->intervalCount = 0;
+    stats->intervalStartNs = nowNs;
+}
+
+static void reportSession(const SinkStats *stats) {
+    if (stats->count == 0) {
+        printf("[Sink] Connection closed, no alerts received\n");
+        return;
+    }
+
+    double seconds = (stats->lastNs - stats->firstNs) / 1e9;
+    printf("[Sink] Connection closed: %ld alerts (%ld invalid records)\n",
+           stats->count, stats->invalid);
+    if (seconds > 0) {
+        printf("[Sink] Sustained: %.0f alerts/s over %.3f s\n", stats->count / seconds, seconds);
+    }
+    printf("[Sink] Latency us: avg %.1f | p50 %d | p99 %d | max %.1f\n",
+           stats->latencySumUs / stats->count,
+           latencyPercentile(stats, 0.50), latencyPercentile(stats, 0.99),
+           stats->latencyMaxUs);
+}
+
+static void serveConnection(int fd, SinkStats *stats) {
+    unsigned char buffer[SINK_BUFFER_SIZE];
+    int buffered = 0;
+
+    while (1) {
+        ssize_t received = recv(fd, buffer + buffered, sizeof(buffer) - buffered, 0);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) break;
+
+        long long nowNs = alertClockNs();
+        buffered += (int)received;
+
+        int offset = 0;
+        while (buffered - offset >= ALERT_WIRE_SIZE) {
+            AlertEvent alert;
+            if (deserializeAlert(buffer + offset, &alert)) {
+                recordAlert(stats, &alert, nowNs);
+            } else {
+                stats->invalid++;
+            }
+            offset += ALERT_WIRE_SIZE;
+        }
+
+        memmove(buffer, buffer + offset, buffered - offset);
+        buffered -= offset;
+        reportInterval(stats, nowNs);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *socketPath = (argc > 1) ? argv[1] : ALERT_SOCKET_PATH;
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        printf("Error: Could not create sink socket\n");
+        return 1;
+    }
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath, sizeof(address.sun_path) - 1);
+    unlink(socketPath);
+
+    if (bind(listenFd, (struct sockaddr*)&address, sizeof(address)) < 0 ||
+        listen(listenFd, 1) < 0) {
+        printf("Error: Could not listen on %s\n", socketPath);
+        close(listenFd);
+        return 1;
+    }
+
+    long *histogram = (long*)malloc(LATENCY_BINS * sizeof(long));
+    if (histogram == NULL) {
+        printf("Error: Memory allocation failed for latency histogram\n");
+        close(listenFd);
+        return 1;
+    }
+
+    printf("[Sink] Listening on %s\n", socketPath);
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    while (1) {
+        int fd = accept(listenFd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        SinkStats stats;
+        memset(&stats, 0, sizeof(stats));
+        memset(histogram, 0, LATENCY_BINS * sizeof(long));
+        stats.histogram = histogram;
+        stats.intervalStartNs = alertClockNs();
+
+        printf("[Sink] Dispatcher connected\n");
+        serveConnection(fd, &stats);
+        reportSession(&stats);
+        close(fd);
+    }
+
+    free(histogram);
+    close(listenFd);
+    unlink(socketPath);
+    return 0;
+}
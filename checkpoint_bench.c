@@ -0,0 +1,134 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "checkpoint_module.h"
+
+/* Overhead benchmark for checkpoint_module. Runs the same enqueue +
+   queue-to-heap transfer cycle directly on the structures and through the
+   checkpointer (WAL, group fsync, periodic snapshots), then times snapshot
+   pauses with a full heap and a restore from snapshot + WAL tail.
+   Usage: ./checkpoint_bench [cycles] [statePath] */
+
+#define BENCH_CYCLES 1000000L
+#define BENCH_STATE_PATH "careconnect_state.bench"
+#define BENCH_QUEUE_CAPACITY 256
+#define BENCH_SNAPSHOTS 50
+
+static double nowSeconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static HealthReading benchReading(long i) {
+    HealthReading reading;
+    reading.patientId = (int)(i % MAX_PATIENTS);
+    reading.heartRate = 60 + (int)(i % 120);
+    reading.bloodPressure = 100 + (int)(i % 90);
+    reading.spo2 = 80 + (int)(i % 21);
+    return reading;
+}
+
+static void removeState(const char *basePath) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s.wal", basePath);
+    remove(path);
+    snprintf(path, sizeof(path), "%s.snap", basePath);
+    remove(path);
+}
+
+int main(int argc, char *argv[]) {
+    long cycles = (argc > 1) ? atol(argv[1]) : BENCH_CYCLES;
+    const char *basePath = (argc > 2) ? argv[2] : BENCH_STATE_PATH;
+    if (cycles <= 0) {
+        printf("Usage: %s [cycles] [statePath]\n", argv[0]);
+        return 1;
+    }
+
+    /* Patient ids wrap at MAX_PATIENTS, so a heap that size never fills */
+    HealthQueue *queue = createQueue(BENCH_QUEUE_CAPACITY);
+    PriorityHeap *heap = createHeap(MAX_PATIENTS, MAX_PATIENTS);
+    if (queue == NULL || heap == NULL) {
+        printf("Error: Benchmark allocation failed\n");
+        return 1;
+    }
+
+    HealthReading reading;
+    double start = nowSeconds();
+    for (long i = 0; i < cycles; i++) {
+        enqueue(queue, benchReading(i));
+        dequeue(queue, &reading);
+        insertReading(heap, reading);
+    }
+    double memoryElapsed = nowSeconds() - start;
+    destroyQueue(queue);
+    destroyHeap(heap);
+
+    removeState(basePath);
+    queue = createQueue(BENCH_QUEUE_CAPACITY);
+    heap = createHeap(MAX_PATIENTS, MAX_PATIENTS);
+    Checkpointer *checkpoint = createCheckpointer(basePath, queue, heap);
+    if (queue == NULL || heap == NULL || checkpoint == NULL || checkpoint->wal == NULL) {
+        printf("Error: Could not open checkpoint state at %s\n", basePath);
+        return 1;
+    }
+
+    start = nowSeconds();
+    for (long i = 0; i < cycles; i++) {
+        checkpointEnqueue(checkpoint, benchReading(i), i * 16, (int)(i + 1));
+        checkpointTransfer(checkpoint, &reading);
+    }
+    double loggedElapsed = nowSeconds() - start;
+    int snapshotsDuringRun = checkpoint->snapshotCount;
+
+    printf("\n[Bench] %ld enqueue + transfer cycles, heap of %d patients\n", cycles, MAX_PATIENTS);
+    printf("[Bench] In-memory: %.2f M ops/s\n", 2 * cycles / memoryElapsed / 1e6);
+    printf("[Bench] Logged:    %.2f M ops/s (%.1fx slower, %d snapshots, fsync every %d records)\n",
+           2 * cycles / loggedElapsed / 1e6, loggedElapsed / memoryElapsed,
+           snapshotsDuringRun, CHECKPOINT_SYNC_INTERVAL);
+
+    double worstPause = 0;
+    start = nowSeconds();
+    for (int i = 0; i < BENCH_SNAPSHOTS; i++) {
+        double pauseStart = nowSeconds();
+        writeSnapshot(checkpoint);
+        double pause = nowSeconds() - pauseStart;
+        if (pause > worstPause) worstPause = pause;
+    }
+    double snapshotElapsed = nowSeconds() - start;
+    printf("[Bench] Snapshot pause (%d heap entries): avg %.3f ms | max %.3f ms\n",
+           getHeapSize(heap), snapshotElapsed / BENCH_SNAPSHOTS * 1e3, worstPause * 1e3);
+
+    /* Leave a WAL tail just short of the next snapshot, sync it, then drop
+       the checkpointer without its closing snapshot, as a crash would */
+    long tail = CHECKPOINT_SNAPSHOT_INTERVAL / 2 - 1;
+    for (long i = 0; i < tail; i++) {
+        checkpointEnqueue(checkpoint, benchReading(i), i * 16, (int)(i + 1));
+        checkpointTransfer(checkpoint, &reading);
+    }
+    syncCheckpoint(checkpoint);
+    fclose(checkpoint->wal);
+    free(checkpoint);
+
+    HealthQueue *restoredQueue = createQueue(BENCH_QUEUE_CAPACITY);
+    PriorityHeap *restoredHeap = createHeap(MAX_PATIENTS, MAX_PATIENTS);
+    start = nowSeconds();
+    Checkpointer *restored = createCheckpointer(basePath, restoredQueue, restoredHeap);
+    double restoreElapsed = nowSeconds() - start;
+    if (restored == NULL || getHeapSize(restoredHeap) != getHeapSize(heap)) {
+        printf("Error: Restore did not reproduce the heap\n");
+        return 1;
+    }
+    printf("[Bench] Restore (snapshot + %ld WAL records): %.3f ms\n\n",
+           2 * tail, restoreElapsed * 1e3);
+
+    finishCheckpoint(restored);
+    destroyCheckpointer(restored);
+    removeState(basePath);
+    destroyQueue(queue);
+    destroyHeap(heap);
+    destroyQueue(restoredQueue);
+    destroyHeap(restoredHeap);
+    return 0;
+}
@@ -0,0 +1,514 @@
+#define _POSIX_C_SOURCE 200809L
+#include "checkpoint_module.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define CHECKSUM_SEED 2166136261u
+
+/* FNV-1a; enough to detect torn or partially written records */
+static unsigned int checksumBytes(unsigned int hash, const void *data, size_t length) {
+    const unsigned char *bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static unsigned int recordChecksum(const WalRecord *record) {
+    return checksumBytes(CHECKSUM_SEED, record, offsetof(WalRecord, checksum));
+}
+
+static int syncFile(FILE *file) {
+    if (fflush(file) != 0) return 0;
+    return (fsync(fileno(file)) == 0);
+}
+
+/* Makes a rename() in the checkpoint directory durable */
+static void syncDirectory(const char *path) {
+    char directory[256];
+    strncpy(directory, path, sizeof(directory) - 1);
+    directory[sizeof(directory) - 1] = '\0';
+
+    char *slash = strrchr(directory, '/');
+    if (slash == NULL) {
+        strcpy(directory, ".");
+    } else if (slash == directory) {
+        slash[1] = '\0';
+    } else {
+        *slash = '\0';
+    }
+
+    int fd = open(directory, O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+static int loadSnapshot(Checkpointer *checkpoint) {
+    FILE *file = fopen(checkpoint->snapshotPath, "rb");
+    if (file == NULL) return 0;
+
+    HealthQueue *queue = checkpoint->queue;
+    PriorityHeap *heap = checkpoint->heap;
+    SnapshotHeader header;
+    HealthReading *readings = NULL;
+    PriorityNode *nodes = NULL;
+    unsigned int stored = 0;
+    int valid = 0;
+
+    if (fread(&header, sizeof(header), 1, file) == 1 &&
+        header.magic == CHECKPOINT_MAGIC && header.version == CHECKPOINT_VERSION &&
+        header.queueSize >= 0 && header.queueSize <= queue->capacity &&
+        header.heapSize >= 0 && header.heapSize <= heap->capacity) {
+        readings = (HealthReading*)malloc((header.queueSize + 1) * sizeof(HealthReading));
+        nodes = (PriorityNode*)malloc((header.heapSize + 1) * sizeof(PriorityNode));
+
+        if (readings != NULL && nodes != NULL &&
+            fread(readings, sizeof(HealthReading), header.queueSize, file) == (size_t)header.queueSize &&
+            fread(nodes, sizeof(PriorityNode), header.heapSize, file) == (size_t)header.heapSize &&
+            fread(&stored, sizeof(stored), 1, file) == 1) {
+            unsigned int checksum = checksumBytes(CHECKSUM_SEED, &header, sizeof(header));
+            checksum = checksumBytes(checksum, readings, header.queueSize * sizeof(HealthReading));
+            checksum = checksumBytes(checksum, nodes, header.heapSize * sizeof(PriorityNode));
+            valid = (checksum == stored);
+        }
+    }
+    fclose(file);
+
+    for (int i = 0; valid && i < header.heapSize; i++) {
+        int patientId = nodes[i].reading.patientId;
+        if (patientId < 0 || patientId >= heap->maxPatients) valid = 0;
+    }
+
+    if (!valid) {
+        printf("[Checkpoint] Warning: Ignoring unreadable snapshot %s\n", checkpoint->snapshotPath);
+        free(readings);
+        free(nodes);
+        return 0;
+    }
+
+    memcpy(queue->data, readings, header.queueSize * sizeof(HealthReading));
+    queue->front = 0;
+    queue->rear = header.queueSize - 1;
+    queue->size = header.queueSize;
+
+    memcpy(heap->heap, nodes, header.heapSize * sizeof(PriorityNode));
+    for (int i = 0; i < header.heapSize; i++) {
+        heap->positions[nodes[i].reading.patientId] = i;
+    }
+    heap->size = header.heapSize;
+    heap->counter = header.heapCounter;
+
+    checkpoint->sequence = header.sequence;
+    checkpoint->inputOffset = header.inputOffset;
+    checkpoint->inputDevice = header.inputDevice;
+    checkpoint->inputInode = header.inputInode;
+    checkpoint->inputSize = header.inputSize;
+    checkpoint->hasInput = header.hasInput;
+    checkpoint->readCount = header.readCount;
+
+    free(readings);
+    free(nodes);
+    return 1;
+}
+
+static int applyRecord(Checkpointer *checkpoint, const WalRecord *record) {
+    HealthReading reading;
+
+    switch (record->type) {
+        case WAL_ENQUEUE:
+            checkpoint->inputOffset = record->inputOffset;
+            checkpoint->readCount = record->readCount;
+            return enqueue(checkpoint->queue, record->reading);
+        case WAL_DEQUEUE:
+            return dequeue(checkpoint->queue, &reading);
+        case WAL_TRANSFER:
+            return dequeue(checkpoint->queue, &reading) &&
+                   insertReading(checkpoint->heap, reading);
+        case WAL_SKIP:
+            checkpoint->inputOffset = record->inputOffset;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Replays records newer than the snapshot and cuts off any torn tail so
+   new records are appended after the last consistent one. */
+static long replayWal(Checkpointer *checkpoint) {
+    FILE *file = fopen(checkpoint->walPath, "rb");
+    if (file == NULL) return 0;
+
+    WalRecord record;
+    long goodOffset = 0;
+    long replayed = 0;
+
+    while (fread(&record, sizeof(record), 1, file) == 1) {
+        if (record.checksum != recordChecksum(&record)) break;
+
+        if (record.sequence > checkpoint->sequence) {
+            if (record.sequence != checkpoint->sequence + 1) break;
+            applyRecord(checkpoint, &record);
+            checkpoint->sequence = record.sequence;
+            replayed++;
+        }
+        goodOffset = ftell(file);
+    }
+    fclose(file);
+
+    if (truncate(checkpoint->walPath, goodOffset) != 0) {
+        printf("[Checkpoint] Warning: Could not trim %s\n", checkpoint->walPath);
+    }
+    return replayed;
+}
+
+Checkpointer* createCheckpointer(const char *basePath, HealthQueue *queue, PriorityHeap *heap) {
+    if (basePath == NULL || queue == NULL || heap == NULL) {
+        printf("Error: Checkpointer needs a path, queue and heap\n");
+        return NULL;
+    }
+
+    Checkpointer *checkpoint = (Checkpointer*)calloc(1, sizeof(Checkpointer));
+    if (checkpoint == NULL) {
+        printf("Error: Memory allocation failed for checkpointer\n");
+        return NULL;
+    }
+
+    snprintf(checkpoint->walPath, sizeof(checkpoint->walPath), "%s.wal", basePath);
+    snprintf(checkpoint->snapshotPath, sizeof(checkpoint->snapshotPath), "%s.snap", basePath);
+    snprintf(checkpoint->tempPath, sizeof(checkpoint->tempPath), "%s.snap.tmp", basePath);
+    checkpoint->queue = queue;
+    checkpoint->heap = heap;
+
+    /* Opened before anything is restored, so a state directory we cannot
+       write to leaves the queue and heap untouched */
+    checkpoint->wal = fopen(checkpoint->walPath, "ab");
+    if (checkpoint->wal == NULL) {
+        printf("[Checkpoint] Warning: Could not open %s, running without persistence\n",
+               checkpoint->walPath);
+        return checkpoint;
+    }
+
+    int fromSnapshot = loadSnapshot(checkpoint);
+    long replayed = replayWal(checkpoint);
+    checkpoint->restored = (fromSnapshot || replayed > 0);
+    checkpoint->sinceSnapshot = (int)replayed;
+
+    if (checkpoint->restored) {
+        printf("[Checkpoint] Restored sequence %lld (%s + %ld WAL records), input offset: %lld\n",
+               checkpoint->sequence, fromSnapshot ? "snapshot" : "no snapshot",
+               replayed, checkpoint->inputOffset);
+    } else {
+        printf("[Checkpoint] Logging to %s\n", checkpoint->walPath);
+    }
+    return checkpoint;
+}
+
+void destroyCheckpointer(Checkpointer *checkpoint) {
+    if (checkpoint == NULL) return;
+
+    if (checkpoint->wal == NULL) {
+        printf("[Checkpoint] Closed (not persisted)\n");
+    } else if (checkpoint->finished) {
+        /* Input fully consumed: the next run starts from scratch */
+        fclose(checkpoint->wal);
+        remove(checkpoint->walPath);
+        remove(checkpoint->snapshotPath);
+        printf("[Checkpoint] Input complete, state cleared at sequence %lld\n",
+               checkpoint->sequence);
+    } else {
+        /* A final snapshot lets the next start skip WAL replay entirely */
+        writeSnapshot(checkpoint);
+        fclose(checkpoint->wal);
+        printf("[Checkpoint] Closed at sequence %lld (%d snapshots)\n",
+               checkpoint->sequence, checkpoint->snapshotCount);
+    }
+    free(checkpoint);
+}
+
+static void clearRestoredState(Checkpointer *checkpoint) {
+    HealthQueue *queue = checkpoint->queue;
+    PriorityHeap *heap = checkpoint->heap;
+
+    queue->front = 0;
+    queue->rear = -1;
+    queue->size = 0;
+
+    for (int i = 0; i < heap->size; i++) {
+        heap->positions[heap->heap[i].reading.patientId] = -1;
+    }
+    heap->size = 0;
+    heap->counter = 0;
+
+    checkpoint->inputOffset = 0;
+    checkpoint->readCount = 0;
+    checkpoint->restored = 0;
+}
+
+static void resetCheckpoint(Checkpointer *checkpoint) {
+    clearRestoredState(checkpoint);
+
+    fflush(checkpoint->wal);
+    if (ftruncate(fileno(checkpoint->wal), 0) != 0) {
+        printf("[Checkpoint] Warning: Could not truncate %s\n", checkpoint->walPath);
+    }
+    checkpoint->unsynced = 0;
+    checkpoint->sinceSnapshot = 0;
+}
+
+/* Falls back to an in-memory run from the top of the input. Saved files
+   are left alone so a later run can still resume from them. */
+static void disablePersistence(Checkpointer *checkpoint, FILE *input) {
+    if (checkpoint->restored) {
+        clearRestoredState(checkpoint);
+    }
+    rewind(input);
+    fclose(checkpoint->wal);
+    checkpoint->wal = NULL;
+    printf("[Checkpoint] Warning: Running without persistence\n");
+}
+
+/* Binds the checkpoint to the input file. Restored state is only kept if
+   it was taken from the same file and that file has not shrunk; the input
+   is then positioned just after the last consumed line. */
+int attachCheckpointInput(Checkpointer *checkpoint, FILE *input) {
+    if (checkpoint == NULL || input == NULL) {
+        printf("[Checkpoint] Error: Invalid checkpointer or input file\n");
+        return 0;
+    }
+
+    if (checkpoint->wal == NULL) {
+        return 0;
+    }
+
+    struct stat info;
+    if (fstat(fileno(input), &info) != 0) {
+        printf("[Checkpoint] Error: Could not stat input file\n");
+        disablePersistence(checkpoint, input);
+        return 0;
+    }
+
+    long long device = (long long)info.st_dev;
+    long long inode = (long long)info.st_ino;
+    long long size = (long long)info.st_size;
+
+    if (checkpoint->restored) {
+        const char *reason = NULL;
+        if (!checkpoint->hasInput) {
+            reason = "no input file recorded";
+        } else if (device != checkpoint->inputDevice || inode != checkpoint->inputInode) {
+            reason = "input file was replaced";
+        } else if (size < checkpoint->inputSize || size < checkpoint->inputOffset) {
+            reason = "input file was truncated";
+        } else if (fseek(input, (long)checkpoint->inputOffset, SEEK_SET) != 0) {
+            reason = "could not seek to saved offset";
+        }
+
+        if (reason != NULL) {
+            printf("[Checkpoint] Warning: Discarding saved state (%s)\n", reason);
+            resetCheckpoint(checkpoint);
+            rewind(input);
+        }
+    }
+
+    checkpoint->inputDevice = device;
+    checkpoint->inputInode = inode;
+    checkpoint->inputSize = size;
+    checkpoint->hasInput = 1;
+
+    /* Record the input identity right away so a WAL-only restore never
+       has to guess which file its offsets belong to */
+    if (!writeSnapshot(checkpoint)) {
+        disablePersistence(checkpoint, input);
+        return 0;
+    }
+    return 1;
+}
+
+void finishCheckpoint(Checkpointer *checkpoint) {
+    if (checkpoint == NULL) return;
+    checkpoint->finished = 1;
+}
+
+static int appendRecord(Checkpointer *checkpoint, WalRecordType type, HealthReading reading) {
+    if (checkpoint == NULL) {
+        printf("[Checkpoint] Error: Checkpointer is NULL\n");
+        return 0;
+    }
+    if (checkpoint->wal == NULL) {
+        return 1;
+    }
+
+    WalRecord record;
+    memset(&record, 0, sizeof(record));
+    record.sequence = checkpoint->sequence + 1;
+    record.inputOffset = checkpoint->inputOffset;
+    record.type = type;
+    record.readCount = checkpoint->readCount;
+    record.reading = reading;
+    record.checksum = recordChecksum(&record);
+
+    if (fwrite(&record, sizeof(record), 1, checkpoint->wal) != 1) {
+        printf("[Checkpoint] Error: Write-ahead log append failed\n");
+        return 0;
+    }
+
+    checkpoint->sequence = record.sequence;
+    checkpoint->unsynced++;
+    checkpoint->sinceSnapshot++;
+
+    if (checkpoint->sinceSnapshot >= CHECKPOINT_SNAPSHOT_INTERVAL) {
+        return writeSnapshot(checkpoint);
+    }
+    if (checkpoint->unsynced >= CHECKPOINT_SYNC_INTERVAL) {
+        return syncCheckpoint(checkpoint);
+    }
+    return 1;
+}
+
+/* The queue and heap are only mutated through these wrappers, so every
+   change that replay must reproduce is logged. */
+int checkpointEnqueue(Checkpointer *checkpoint, HealthReading reading, long inputOffset, int readCount) {
+    if (checkpoint == NULL) {
+        printf("[Checkpoint] Error: Checkpointer is NULL\n");
+        return 0;
+    }
+
+    if (!enqueue(checkpoint->queue, reading)) {
+        return 0;
+    }
+    checkpoint->inputOffset = inputOffset;
+    checkpoint->readCount = readCount;
+    appendRecord(checkpoint, WAL_ENQUEUE, reading);
+    return 1;
+}
+
+/* Moves the front reading into the heap. Returns 1 if a reading was
+   dequeued, even when the heap rejected it. The move is one record: a WAL
+   cut between a dequeue and a heap insert would lose the reading, since
+   the input offset is already past its line. */
+int checkpointTransfer(Checkpointer *checkpoint, HealthReading *reading) {
+    if (checkpoint == NULL || reading == NULL) {
+        printf("[Checkpoint] Error: Invalid checkpointer or reading pointer\n");
+        return 0;
+    }
+
+    if (!dequeue(checkpoint->queue, reading)) {
+        return 0;
+    }
+    if (insertReading(checkpoint->heap, *reading)) {
+        appendRecord(checkpoint, WAL_TRANSFER, *reading);
+    } else {
+        appendRecord(checkpoint, WAL_DEQUEUE, *reading);
+    }
+    return 1;
+}
+
+/* Marks a rejected input line as consumed. Without this a restart would
+   resume in front of it and stop on it again forever. */
+int checkpointSkipInput(Checkpointer *checkpoint, long inputOffset) {
+    if (checkpoint == NULL) {
+        printf("[Checkpoint] Error: Checkpointer is NULL\n");
+        return 0;
+    }
+
+    HealthReading none;
+    memset(&none, 0, sizeof(none));
+    checkpoint->inputOffset = inputOffset;
+    return appendRecord(checkpoint, WAL_SKIP, none);
+}
+
+int writeSnapshot(Checkpointer *checkpoint) {
+    if (checkpoint == NULL) {
+        printf("[Checkpoint] Error: Checkpointer is NULL\n");
+        return 0;
+    }
+
+    if (checkpoint->wal == NULL) {
+        return 0;
+    }
+
+    const HealthQueue *queue = checkpoint->queue;
+    const PriorityHeap *heap = checkpoint->heap;
+
+    FILE *file = fopen(checkpoint->tempPath, "wb");
+    if (file == NULL) {
+        printf("[Checkpoint] Error: Could not create %s\n", checkpoint->tempPath);
+        return 0;
+    }
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = CHECKPOINT_MAGIC;
+    header.version = CHECKPOINT_VERSION;
+    header.sequence = checkpoint->sequence;
+    header.inputOffset = checkpoint->inputOffset;
+    header.inputDevice = checkpoint->inputDevice;
+    header.inputInode = checkpoint->inputInode;
+    header.inputSize = checkpoint->inputSize;
+    header.hasInput = checkpoint->hasInput;
+    header.readCount = checkpoint->readCount;
+    header.heapCounter = heap->counter;
+    header.queueSize = queue->size;
+    header.heapSize = heap->size;
+
+    int ok = (fwrite(&header, sizeof(header), 1, file) == 1);
+    unsigned int checksum = checksumBytes(CHECKSUM_SEED, &header, sizeof(header));
+
+    for (int i = 0; ok && i < queue->size; i++) {
+        const HealthReading *reading = &queue->data[(queue->front + i) % queue->capacity];
+        ok = (fwrite(reading, sizeof(HealthReading), 1, file) == 1);
+        checksum = checksumBytes(checksum, reading, sizeof(HealthReading));
+    }
+
+    if (ok) {
+        ok = (fwrite(heap->heap, sizeof(PriorityNode), heap->size, file) == (size_t)heap->size);
+        checksum = checksumBytes(checksum, heap->heap, heap->size * sizeof(PriorityNode));
+    }
+
+    ok = ok && (fwrite(&checksum, sizeof(checksum), 1, file) == 1) && syncFile(file);
+    fclose(file);
+
+    if (!ok || rename(checkpoint->tempPath, checkpoint->snapshotPath) != 0) {
+        printf("[Checkpoint] Error: Snapshot write failed\n");
+        remove(checkpoint->tempPath);
+        return 0;
+    }
+    syncDirectory(checkpoint->snapshotPath);
+
+    /* Everything in the WAL is now covered by the snapshot. Records left
+       behind by a crash before this truncation are skipped by sequence. */
+    fflush(checkpoint->wal);
+    if (ftruncate(fileno(checkpoint->wal), 0) != 0) {
+        printf("[Checkpoint] Warning: Could not truncate %s\n", checkpoint->walPath);
+    }
+
+    checkpoint->unsynced = 0;
+    checkpoint->sinceSnapshot = 0;
+    checkpoint->snapshotCount++;
+    return 1;
+}
+
+int syncCheckpoint(Checkpointer *checkpoint) {
+    if (checkpoint == NULL) {
+        printf("[Checkpoint] Error: Checkpointer is NULL\n");
+        return 0;
+    }
+    if (checkpoint->wal == NULL) {
+        return 0;
+    }
+
+    if (!syncFile(checkpoint->wal)) {
+        printf("[Checkpoint] Error: Could not sync %s\n", checkpoint->walPath);
+        return 0;
+    }
+    checkpoint->unsynced = 0;
+    return 1;
+}
@@ -0,0 +1,77 @@
+#ifndef CHECKPOINT_MODULE_H
+#define CHECKPOINT_MODULE_H
+
+#include "queue_module.h"
+#include "heap_module.h"
+
+#define CHECKPOINT_MAGIC 0x43434B50
+#define CHECKPOINT_VERSION 2
+#define CHECKPOINT_SNAPSHOT_INTERVAL 8192   /* WAL records between snapshots */
+
+/* WAL records between fsyncs. Losing an unsynced tail only rewinds the
+   logged input offset, so those readings are simply parsed again. */
+#define CHECKPOINT_SYNC_INTERVAL 1024
+
+typedef enum {
+    WAL_ENQUEUE = 1,
+    WAL_DEQUEUE = 2,        /* dequeued, but the heap rejected the reading */
+    WAL_TRANSFER = 6,       /* dequeue + heap insert, applied atomically */
+    WAL_SKIP = 7            /* rejected input line, only advances the offset */
+} WalRecordType;
+
+typedef struct {
+    long long sequence;
+    long long inputOffset;
+    int type;
+    int readCount;
+    HealthReading reading;
+    unsigned int checksum;
+} WalRecord;
+
+typedef struct {
+    unsigned int magic;
+    int version;
+    long long sequence;
+    long long inputOffset;
+    long long inputDevice;
+    long long inputInode;
+    long long inputSize;
+    int hasInput;
+    int readCount;
+    int heapCounter;
+    int queueSize;
+    int heapSize;
+} SnapshotHeader;
+
+typedef struct {
+    HealthQueue *queue;
+    PriorityHeap *heap;
+    FILE *wal;              /* NULL when running without persistence */
+    char walPath[256];
+    char snapshotPath[256];
+    char tempPath[256];
+    long long sequence;
+    long long inputOffset;
+    long long inputDevice;  /* identity and size of the attached input file */
+    long long inputInode;
+    long long inputSize;
+    int hasInput;
+    int readCount;
+    int restored;
+    int finished;
+    int unsynced;
+    int sinceSnapshot;
+    int snapshotCount;
+} Checkpointer;
+
+Checkpointer* createCheckpointer(const char *basePath, HealthQueue *queue, PriorityHeap *heap);
+void destroyCheckpointer(Checkpointer *checkpoint);
+int attachCheckpointInput(Checkpointer *checkpoint, FILE *input);
+void finishCheckpoint(Checkpointer *checkpoint);
+int checkpointEnqueue(Checkpointer *checkpoint, HealthReading reading, long inputOffset, int readCount);
+int checkpointTransfer(Checkpointer *checkpoint, HealthReading *reading);
+int checkpointSkipInput(Checkpointer *checkpoint, long inputOffset);
+int writeSnapshot(Checkpointer *checkpoint);
+int syncCheckpoint(Checkpointer *checkpoint);
+
+#endif
@@ -2,9 +2,9 @@
 #include <stdlib.h>
 #include <stdio.h>
 
-PriorityHeap* createHeap(int capacity) {
-    if (capacity <= 0) {
-        printf("Error: Heap capacity must be positive\n");
+PriorityHeap* createHeap(int capacity, int maxPatients) {
+    if (capacity <= 0 || maxPatients <= 0) {
+        printf("Error: Heap capacity and patient limit must be positive\n");
         return NULL;
     }
     
@@ -21,23 +21,40 @@ PriorityHeap* createHeap(int capacity) {
         return NULL;
     }
     
+    heap->positions = (int*)malloc(maxPatients * sizeof(int));
+    if (heap->positions == NULL) {
+        printf("Error: Memory allocation failed for heap position index\n");
+        free(heap->heap);
+        free(heap);
+        return NULL;
+    }
+    
+    for (int i = 0; i < maxPatients; i++) {
+        heap->positions[i] = -1;
+    }
+    
     heap->capacity = capacity;
+    heap->maxPatients = maxPatients;
     heap->size = 0;
     heap->counter = 0;
     
-    printf("[Heap] Initialized with capacity: %d\n", capacity);
+    printf("[Heap] Initialized with capacity: %d, patients: %d\n", capacity, maxPatients);
     return heap;
 }
 
 void destroyHeap(PriorityHeap *heap) {
     if (heap == NULL) return;
     free(heap->heap);
+    free(heap->positions);
     free(heap);
     printf("[Heap] Destroyed\n");
 }
 
 void initializeHeap(PriorityHeap *heap) {
     if (heap == NULL) return;
+    for (int i = 0; i < heap->size; i++) {
+        heap->positions[heap->heap[i].reading.patientId] = -1;
+    }
     heap->size = 0;
     heap->counter = 0;
     printf("[Heap] Re-initialized\n");
@@ -55,6 +72,19 @@ PriorityLevel calculatePriority(HealthReading reading) {
     }
 }
 
+static void swapNodes(PriorityHeap *heap, int i, int j) {
+    PriorityNode temp = heap->heap[i];
+    heap->heap[i] = heap->heap[j];
+    heap->heap[j] = temp;
+    
+    heap->positions[heap->heap[i].reading.patientId] = i;
+    heap->positions[heap->heap[j].reading.patientId] = j;
+}
+
+static int isValidPatient(const PriorityHeap *heap, int patientId) {
+    return (patientId >= 0 && patientId < heap->maxPatients);
+}
+
 int isHeapEmpty(const PriorityHeap *heap) {
     if (heap == NULL) return 1;
     return (heap->size == 0);
@@ -71,6 +101,29 @@ int insertReading(PriorityHeap *heap, HealthReading reading) {
         return 0;
     }
     
+    if (!isValidPatient(heap, reading.patientId)) {
+        printf("[Heap] Error: Invalid patient id %d (max: %d)\n", 
+               reading.patientId, heap->maxPatients - 1);
+        return 0;
+    }
+    
+    int index = heap->positions[reading.patientId];
+    if (index >= 0) {
+        /* Patient already queued: refresh the entry in place. The original
+           timestamp is kept so the patient does not lose its turn among
+           readings of equal priority. */
+        PriorityLevel oldPriority = heap->heap[index].priority;
+        heap->heap[index].reading = reading;
+        heap->heap[index].priority = calculatePriority(reading);
+        
+        if (heap->heap[index].priority > oldPriority) {
+            heapifyUp(heap, index);
+        } else if (heap->heap[index].priority < oldPriority) {
+            heapifyDown(heap, index);
+        }
+        return 1;
+    }
+    
     if (isHeapFull(heap)) {
         printf("[Heap] Error: Heap is full (capacity: %d)\n", heap->capacity);
         return 0;
@@ -82,8 +135,9 @@ int insertReading(PriorityHeap *heap, HealthReading reading) {
     newNode.timestamp = heap->counter++;
     
     heap->heap[heap->size] = newNode;
-    heapifyUp(heap, heap->size);
+    heap->positions[reading.patientId] = heap->size;
     heap->size++;
+    heapifyUp(heap, heap->size - 1);
     
     return 1;
 }
@@ -100,16 +154,56 @@ int extractMaxPriority(PriorityHeap *heap, PriorityNode *node) {
     }
     
     *node = heap->heap[0];
-    heap->heap[0] = heap->heap[heap->size - 1];
+    heap->positions[node->reading.patientId] = -1;
     heap->size--;
     
     if (heap->size > 0) {
+        heap->heap[0] = heap->heap[heap->size];
+        heap->positions[heap->heap[0].reading.patientId] = 0;
         heapifyDown(heap, 0);
     }
     
     return 1;
 }
 
+int removeByPatient(PriorityHeap *heap, int patientId, PriorityNode *node) {
+    if (heap == NULL) {
+        printf("[Heap] Error: Heap is NULL\n");
+        return 0;
+    }
+    
+    if (!isValidPatient(heap, patientId)) {
+        printf("[Heap] Error: Invalid patient id %d (max: %d)\n", 
+               patientId, heap->maxPatients - 1);
+        return 0;
+    }
+    
+    int index = heap->positions[patientId];
+    if (index < 0) {
+        return 0;
+    }
+    
+    if (node != NULL) {
+        *node = heap->heap[index];
+    }
+    heap->positions[patientId] = -1;
+    heap->size--;
+    
+    if (index < heap->size) {
+        heap->heap[index] = heap->heap[heap->size];
+        heap->positions[heap->heap[index].reading.patientId] = index;
+        heapifyUp(heap, index);
+        heapifyDown(heap, index);
+    }
+    
+    return 1;
+}
+
+int containsPatient(const PriorityHeap *heap, int patientId) {
+    if (heap == NULL || !isValidPatient(heap, patientId)) return 0;
+    return (heap->positions[patientId] >= 0);
+}
+
 void heapifyUp(PriorityHeap *heap, int index) {
     if (heap == NULL || index <= 0) return;
     
@@ -120,9 +214,7 @@ void heapifyUp(PriorityHeap *heap, int index) {
                      heap->heap[index].timestamp < heap->heap[parent].timestamp);
     
     if (shouldSwap) {
-        PriorityNode temp = heap->heap[index];
-        heap->heap[index] = heap->heap[parent];
-        heap->heap[parent] = temp;
+        swapNodes(heap, index, parent);
         heapifyUp(heap, parent);
     }
 }
@@ -149,9 +241,7 @@ void heapifyDown(PriorityHeap *heap, int index) {
     }
     
     if (largest != index) {
-        PriorityNode temp = heap->heap[index];
-        heap->heap[index] = heap->heap[largest];
-        heap->heap[largest] = temp;
+        swapNodes(heap, index, largest);
         heapifyDown(heap, largest);
     }
 }
@@ -168,7 +258,8 @@ void displayHeap(const PriorityHeap *heap) {
         const char* priorityStr = (heap->heap[i].priority == CRITICAL) ? "CRITICAL" : 
                                  (heap->heap[i].priority == WARNING) ? "WARNING" : "NORMAL";
         
-        printf("  [%d] [%s] ", i + 1, priorityStr);
+        printf("  [%d] [%s] Patient %d | ", i + 1, priorityStr, 
+               heap->heap[i].reading.patientId);
         displayHealthReading(heap->heap[i].reading);
         printf("\n");
     }
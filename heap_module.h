@@ -17,17 +17,21 @@ typedef struct {
 
 typedef struct {
     PriorityNode *heap;
+    int *positions;     /* patientId -> index in heap, -1 if not queued */
     int size;
     int capacity;
+    int maxPatients;
     int counter;
 } PriorityHeap;
 
-PriorityHeap* createHeap(int capacity);
+PriorityHeap* createHeap(int capacity, int maxPatients);
 void destroyHeap(PriorityHeap *heap);
 void initializeHeap(PriorityHeap *heap);
 PriorityLevel calculatePriority(HealthReading reading);
 int insertReading(PriorityHeap *heap, HealthReading reading);
 int extractMaxPriority(PriorityHeap *heap, PriorityNode *node);
+int removeByPatient(PriorityHeap *heap, int patientId, PriorityNode *node);
+int containsPatient(const PriorityHeap *heap, int patientId);
 void displayHeap(const PriorityHeap *heap);
 int isHeapEmpty(const PriorityHeap *heap);
 int isHeapFull(const PriorityHeap *heap);
@@ -0,0 +1,106 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "history_module.h"
+
+/* Memory-per-reading and query-throughput benchmark for history_module.
+   Simulates BENCH_PATIENTS patients sending one reading per second for
+   a day (random-walk vitals, ~2% timestamp jitter), then times range and
+   downsampled queries. Usage: ./history_bench [patients] */
+
+#define BENCH_PATIENTS 200
+#define BENCH_READINGS (24L * 60 * 60)
+#define BENCH_START_TIME 1700000000L
+#define BENCH_RANGE_QUERIES 50
+#define BENCH_BUCKET_SECONDS 300
+#define BENCH_MAX_BUCKETS (BENCH_READINGS / BENCH_BUCKET_SECONDS + 1)
+
+static double nowSeconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static int clamp(int value, int low, int high) {
+    return (value < low) ? low : (value > high) ? high : value;
+}
+
+int main(int argc, char *argv[]) {
+    int patients = (argc > 1) ? atoi(argv[1]) : BENCH_PATIENTS;
+    if (patients <= 0) {
+        printf("Usage: %s [patients]\n", argv[0]);
+        return 1;
+    }
+
+    /* Retention is longer than the simulated day so nothing expires mid-run */
+    HistoryStore *store = createHistoryStore(patients, 2 * BENCH_READINGS);
+    HistorySample *samples = (HistorySample*)malloc(2 * BENCH_READINGS * sizeof(HistorySample));
+    HistoryBucket *buckets = (HistoryBucket*)malloc(BENCH_MAX_BUCKETS * sizeof(HistoryBucket));
+    if (store == NULL || samples == NULL || buckets == NULL) {
+        printf("Error: Benchmark allocation failed\n");
+        return 1;
+    }
+
+    srand(7);
+    long endTime = BENCH_START_TIME;
+    double start = nowSeconds();
+    for (int p = 0; p < patients; p++) {
+        HealthReading reading = {p, 80, 130, 96};
+        long timestamp = BENCH_START_TIME;
+
+        for (long i = 0; i < BENCH_READINGS; i++) {
+            timestamp += (rand() % 50 == 0) ? 1 + rand() % 3 : 1;
+            reading.heartRate = clamp(reading.heartRate + rand() % 5 - 2, 30, 200);
+            reading.bloodPressure = clamp(reading.bloodPressure + rand() % 3 - 1, 60, 250);
+            if (rand() % 10 == 0) {
+                reading.spo2 = clamp(reading.spo2 + rand() % 3 - 1, 70, 100);
+            }
+            appendHistory(store, timestamp, reading);
+        }
+        if (timestamp > endTime) endTime = timestamp;
+    }
+    double elapsed = nowSeconds() - start;
+
+    long readings = getHistoryReadingCount(store);
+    size_t bytes = getHistoryMemoryUsage(store);
+    printf("\n[Bench] %d patients x %ld readings\n", patients, BENCH_READINGS);
+    printf("[Bench] Append: %.2f M readings/s\n", readings / elapsed / 1e6);
+    printf("[Bench] Memory: %lu bytes, %.2f bytes/reading (raw HistorySample: %lu)\n",
+           (unsigned long)bytes, (double)bytes / readings, (unsigned long)sizeof(HistorySample));
+
+    long decoded = 0;
+    start = nowSeconds();
+    for (int p = 0; p < patients; p++) {
+        decoded += queryHistoryRange(store, p, BENCH_START_TIME, endTime,
+                                     samples, 2 * BENCH_READINGS);
+    }
+    elapsed = nowSeconds() - start;
+    printf("[Bench] Full-day range decode: %.2f M samples/s\n", decoded / elapsed / 1e6);
+
+    long queries = 0;
+    start = nowSeconds();
+    for (int p = 0; p < patients; p++) {
+        for (int k = 0; k < BENCH_RANGE_QUERIES; k++) {
+            long from = BENCH_START_TIME + k * 1000L;
+            queryHistoryRange(store, p, from, from + 3600, samples, 2 * BENCH_READINGS);
+            queries++;
+        }
+    }
+    elapsed = nowSeconds() - start;
+    printf("[Bench] 1 h range queries: %.0f queries/s\n", queries / elapsed);
+
+    start = nowSeconds();
+    for (int p = 0; p < patients; p++) {
+        queryHistoryDownsampled(store, p, BENCH_START_TIME, endTime, BENCH_BUCKET_SECONDS,
+                                buckets, BENCH_MAX_BUCKETS);
+    }
+    elapsed = nowSeconds() - start;
+    printf("[Bench] 24 h downsample (%ds buckets): %.0f queries/s\n\n",
+           BENCH_BUCKET_SECONDS, patients / elapsed);
+
+    free(samples);
+    free(buckets);
+    destroyHistoryStore(store);
+    return 0;
+}
@@ -0,0 +1,438 @@
+#include "history_module.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+/* Worst case per record: 4 + 32 timestamp bits and 3 x (3 + 9) value bits */
+#define HISTORY_MAX_RECORD_BITS 72
+#define HISTORY_BLOCK_BITS (HISTORY_BLOCK_BYTES * 8)
+
+typedef struct {
+    const HistoryBlock *block;
+    int bitPos;
+    int index;
+    long time;
+    long delta;
+    HealthReading value;
+} HistoryCursor;
+
+typedef int (*HistoryVisitor)(void *context, long timestamp, HealthReading reading);
+
+HistoryStore* createHistoryStore(int maxPatients, long retentionSeconds) {
+    if (maxPatients <= 0 || retentionSeconds < 0) {
+        printf("Error: History store parameters must be positive\n");
+        return NULL;
+    }
+
+    HistoryStore *store = (HistoryStore*)malloc(sizeof(HistoryStore));
+    if (store == NULL) {
+        printf("Error: Memory allocation failed for history store\n");
+        return NULL;
+    }
+
+    store->patients = (PatientHistory*)calloc(maxPatients, sizeof(PatientHistory));
+    if (store->patients == NULL) {
+        printf("Error: Memory allocation failed for patient histories\n");
+        free(store);
+        return NULL;
+    }
+
+    store->maxPatients = maxPatients;
+    store->retentionSeconds = retentionSeconds;
+    store->blockCount = 0;
+    store->readingCount = 0;
+
+    printf("[History] Initialized for %d patients, retention: %lds\n",
+           maxPatients, retentionSeconds);
+    return store;
+}
+
+void destroyHistoryStore(HistoryStore *store) {
+    if (store == NULL) return;
+
+    for (int i = 0; i < store->maxPatients; i++) {
+        HistoryBlock *block = store->patients[i].head;
+        while (block != NULL) {
+            HistoryBlock *next = block->next;
+            free(block);
+            block = next;
+        }
+    }
+
+    free(store->patients);
+    free(store);
+    printf("[History] Destroyed\n");
+}
+
+static void writeBits(HistoryBlock *block, unsigned long value, int bits) {
+    for (int i = bits - 1; i >= 0; i--) {
+        if ((value >> i) & 1UL) {
+            block->data[block->bitLength >> 3] |= (unsigned char)(0x80 >> (block->bitLength & 7));
+        }
+        block->bitLength++;
+    }
+}
+
+static unsigned long readBits(HistoryCursor *cursor, int bits) {
+    unsigned long value = 0;
+    for (int i = 0; i < bits; i++) {
+        int pos = cursor->bitPos++;
+        value = (value << 1) | ((cursor->block->data[pos >> 3] >> (7 - (pos & 7))) & 1);
+    }
+    return value;
+}
+
+static long signExtend(unsigned long value, int bits) {
+    long long raw = (long long)value;
+    if (raw & (1LL << (bits - 1))) {
+        raw -= (1LL << bits);
+    }
+    return (long)raw;
+}
+
+static int fitsSigned(long value, int bits) {
+    long long limit = 1LL << (bits - 1);
+    return (value >= -limit && value < limit);
+}
+
+/* Delta-of-delta timestamps: '0' | '10'+7 | '110'+9 | '1110'+12 | '1111'+32 */
+static void encodeTime(HistoryBlock *block, long dod) {
+    if (dod == 0) {
+        writeBits(block, 0x0, 1);
+    } else if (fitsSigned(dod, 7)) {
+        writeBits(block, 0x2, 2);
+        writeBits(block, (unsigned long)dod & 0x7FUL, 7);
+    } else if (fitsSigned(dod, 9)) {
+        writeBits(block, 0x6, 3);
+        writeBits(block, (unsigned long)dod & 0x1FFUL, 9);
+    } else if (fitsSigned(dod, 12)) {
+        writeBits(block, 0xE, 4);
+        writeBits(block, (unsigned long)dod & 0xFFFUL, 12);
+    } else {
+        writeBits(block, 0xF, 4);
+        writeBits(block, (unsigned long)dod & 0xFFFFFFFFUL, 32);
+    }
+}
+
+static long decodeTime(HistoryCursor *cursor) {
+    if (readBits(cursor, 1) == 0) return 0;
+    if (readBits(cursor, 1) == 0) return signExtend(readBits(cursor, 7), 7);
+    if (readBits(cursor, 1) == 0) return signExtend(readBits(cursor, 9), 9);
+    if (readBits(cursor, 1) == 0) return signExtend(readBits(cursor, 12), 12);
+    return signExtend(readBits(cursor, 32), 32);
+}
+
+/* Zigzag channel deltas: '0' | '10'+3 | '110'+6 | '111'+9. Validated
+   readings never differ by more than 255, so 9 bits always suffice. */
+static void encodeValue(HistoryBlock *block, int delta) {
+    unsigned long zigzag = (delta >= 0) ? (unsigned long)delta * 2
+                                        : (unsigned long)(-delta) * 2 - 1;
+    if (zigzag == 0) {
+        writeBits(block, 0x0, 1);
+    } else if (zigzag < 8) {
+        writeBits(block, 0x2, 2);
+        writeBits(block, zigzag, 3);
+    } else if (zigzag < 64) {
+        writeBits(block, 0x6, 3);
+        writeBits(block, zigzag, 6);
+    } else {
+        writeBits(block, 0x7, 3);
+        writeBits(block, zigzag, 9);
+    }
+}
+
+static int decodeValue(HistoryCursor *cursor) {
+    unsigned long zigzag;
+    if (readBits(cursor, 1) == 0) {
+        zigzag = 0;
+    } else if (readBits(cursor, 1) == 0) {
+        zigzag = readBits(cursor, 3);
+    } else if (readBits(cursor, 1) == 0) {
+        zigzag = readBits(cursor, 6);
+    } else {
+        zigzag = readBits(cursor, 9);
+    }
+    return (zigzag & 1) ? -(int)((zigzag + 1) / 2) : (int)(zigzag / 2);
+}
+
+/* Frees whole blocks that ended before the retention window. Returns the
+   number of readings dropped. */
+static long expireHistory(HistoryStore *store, PatientHistory *history, long now) {
+    if (store->retentionSeconds == 0) return 0;
+
+    long expiredReadings = 0;
+    while (history->head != NULL &&
+           history->head->endTime < now - store->retentionSeconds) {
+        HistoryBlock *expired = history->head;
+        history->head = expired->next;
+        store->blockCount--;
+        store->readingCount -= expired->count;
+        expiredReadings += expired->count;
+        free(expired);
+    }
+
+    if (history->head == NULL) {
+        /* Everything aged out: the next append starts a fresh series */
+        history->tail = NULL;
+        history->lastTime = 0;
+        history->lastDelta = 0;
+    }
+    return expiredReadings;
+}
+
+int appendHistory(HistoryStore *store, long timestamp, HealthReading reading) {
+    if (store == NULL) {
+        printf("[History] Error: Store is NULL\n");
+        return 0;
+    }
+
+    if (reading.patientId < 0 || reading.patientId >= store->maxPatients) {
+        printf("[History] Error: Invalid patient id %d (max: %d)\n",
+               reading.patientId, store->maxPatients - 1);
+        return 0;
+    }
+
+    if (!validateHealthReading(reading)) {
+        printf("[History] Error: Invalid health reading for patient %d\n", reading.patientId);
+        return 0;
+    }
+
+    PatientHistory *history = &store->patients[reading.patientId];
+    HistoryBlock *tail = history->tail;
+
+    if (tail != NULL && timestamp < history->lastTime) {
+        printf("[History] Error: Out-of-order timestamp for patient %d\n", reading.patientId);
+        return 0;
+    }
+
+    if (tail != NULL) {
+        long delta = timestamp - history->lastTime;
+        long dod = delta - history->lastDelta;
+
+        if (fitsSigned(dod, 32) &&
+            tail->bitLength + HISTORY_MAX_RECORD_BITS <= HISTORY_BLOCK_BITS) {
+            encodeTime(tail, dod);
+            encodeValue(tail, reading.heartRate - history->last.heartRate);
+            encodeValue(tail, reading.bloodPressure - history->last.bloodPressure);
+            encodeValue(tail, reading.spo2 - history->last.spo2);
+            tail->count++;
+            tail->endTime = timestamp;
+
+            history->lastTime = timestamp;
+            history->lastDelta = delta;
+            history->last = reading;
+            store->readingCount++;
+            expireHistory(store, history, timestamp);
+            return 1;
+        }
+    }
+
+    /* Tail is full (or this is the first reading): seal it and start a new block */
+    HistoryBlock *block = (HistoryBlock*)calloc(1, sizeof(HistoryBlock));
+    if (block == NULL) {
+        printf("[History] Error: Memory allocation failed for history block\n");
+        return 0;
+    }
+
+    block->startTime = timestamp;
+    block->endTime = timestamp;
+    block->first = reading;
+    block->count = 1;
+
+    if (tail == NULL) {
+        history->head = block;
+    } else {
+        tail->next = block;
+    }
+    history->tail = block;
+    history->lastTime = timestamp;
+    history->lastDelta = 0;
+    history->last = reading;
+
+    store->blockCount++;
+    store->readingCount++;
+    expireHistory(store, history, timestamp);
+    return 1;
+}
+
+/* Appends only expire their own patient, so quiet patients are swept here */
+long expireHistoryStore(HistoryStore *store, long now) {
+    if (store == NULL) {
+        printf("[History] Error: Store is NULL\n");
+        return 0;
+    }
+
+    long expiredReadings = 0;
+    for (int i = 0; i < store->maxPatients; i++) {
+        expiredReadings += expireHistory(store, &store->patients[i], now);
+    }
+    return expiredReadings;
+}
+
+static int scanHistory(const HistoryStore *store, int patientId, long from, long to,
+                       HistoryVisitor visit, void *context) {
+    if (store == NULL || visit == NULL) {
+        printf("[History] Error: Invalid store or visitor\n");
+        return 0;
+    }
+
+    if (patientId < 0 || patientId >= store->maxPatients) {
+        printf("[History] Error: Invalid patient id %d (max: %d)\n",
+               patientId, store->maxPatients - 1);
+        return 0;
+    }
+
+    for (const HistoryBlock *block = store->patients[patientId].head;
+         block != NULL; block = block->next) {
+        if (block->endTime < from) continue;
+        if (block->startTime > to) break;
+
+        HistoryCursor cursor;
+        cursor.block = block;
+        cursor.bitPos = 0;
+        cursor.index = 0;
+        cursor.time = block->startTime;
+        cursor.delta = 0;
+        cursor.value = block->first;
+
+        while (1) {
+            if (cursor.time > to) return 1;
+            if (cursor.time >= from && !visit(context, cursor.time, cursor.value)) return 1;
+            if (++cursor.index >= block->count) break;
+
+            cursor.delta += decodeTime(&cursor);
+            cursor.time += cursor.delta;
+            cursor.value.heartRate += decodeValue(&cursor);
+            cursor.value.bloodPressure += decodeValue(&cursor);
+            cursor.value.spo2 += decodeValue(&cursor);
+        }
+    }
+
+    return 1;
+}
+
+typedef struct {
+    HistorySample *samples;
+    int maxSamples;
+    int count;
+} RangeQuery;
+
+static int collectSample(void *context, long timestamp, HealthReading reading) {
+    RangeQuery *query = (RangeQuery*)context;
+    query->samples[query->count].timestamp = timestamp;
+    query->samples[query->count].reading = reading;
+    query->count++;
+    return (query->count < query->maxSamples);
+}
+
+int queryHistoryRange(const HistoryStore *store, int patientId, long from, long to,
+                      HistorySample *samples, int maxSamples) {
+    if (samples == NULL || maxSamples <= 0) {
+        printf("[History] Error: Invalid sample buffer\n");
+        return 0;
+    }
+
+    RangeQuery query = {samples, maxSamples, 0};
+    scanHistory(store, patientId, from, to, collectSample, &query);
+    return query.count;
+}
+
+typedef struct {
+    HistoryBucket *buckets;
+    int maxBuckets;
+    int count;
+    long from;
+    long bucketSeconds;
+    long sums[3];
+} DownsampleQuery;
+
+static void updateChannel(ChannelStats *stats, int value, int first) {
+    if (first || value < stats->min) stats->min = value;
+    if (first || value > stats->max) stats->max = value;
+}
+
+static void finishBucket(DownsampleQuery *query) {
+    HistoryBucket *bucket = &query->buckets[query->count];
+    bucket->heartRate.avg = (double)query->sums[0] / bucket->count;
+    bucket->bloodPressure.avg = (double)query->sums[1] / bucket->count;
+    bucket->spo2.avg = (double)query->sums[2] / bucket->count;
+    query->count++;
+}
+
+static int accumulateSample(void *context, long timestamp, HealthReading reading) {
+    DownsampleQuery *query = (DownsampleQuery*)context;
+    long startTime = query->from +
+                     ((timestamp - query->from) / query->bucketSeconds) * query->bucketSeconds;
+    HistoryBucket *bucket = &query->buckets[query->count];
+
+    if (bucket->count > 0 && bucket->startTime != startTime) {
+        finishBucket(query);
+        if (query->count >= query->maxBuckets) return 0;
+        bucket = &query->buckets[query->count];
+        bucket->count = 0;
+    }
+
+    if (bucket->count == 0) {
+        bucket->startTime = startTime;
+        query->sums[0] = query->sums[1] = query->sums[2] = 0;
+    }
+
+    updateChannel(&bucket->heartRate, reading.heartRate, bucket->count == 0);
+    updateChannel(&bucket->bloodPressure, reading.bloodPressure, bucket->count == 0);
+    updateChannel(&bucket->spo2, reading.spo2, bucket->count == 0);
+    query->sums[0] += reading.heartRate;
+    query->sums[1] += reading.bloodPressure;
+    query->sums[2] += reading.spo2;
+    bucket->count++;
+    return 1;
+}
+
+int queryHistoryDownsampled(const HistoryStore *store, int patientId, long from, long to,
+                            long bucketSeconds, HistoryBucket *buckets, int maxBuckets) {
+    if (buckets == NULL || maxBuckets <= 0 || bucketSeconds <= 0) {
+        printf("[History] Error: Invalid bucket buffer or width\n");
+        return 0;
+    }
+
+    DownsampleQuery query;
+    query.buckets = buckets;
+    query.maxBuckets = maxBuckets;
+    query.count = 0;
+    query.from = from;
+    query.bucketSeconds = bucketSeconds;
+    buckets[0].count = 0;
+
+    scanHistory(store, patientId, from, to, accumulateSample, &query);
+
+    if (query.count < maxBuckets && buckets[query.count].count > 0) {
+        finishBucket(&query);
+    }
+    return query.count;
+}
+
+void displayHistoryBuckets(const HistoryBucket *buckets, int count) {
+    if (buckets == NULL || count <= 0) {
+        printf("[History] Empty\n");
+        return;
+    }
+
+    printf("[History] Buckets: %d\n", count);
+    for (int i = 0; i < count; i++) {
+        printf("  [%ld] n=%d | HR %d-%d (%.1f) | BP %d-%d (%.1f) | SpO2 %d-%d (%.1f)\n",
+               buckets[i].startTime, buckets[i].count,
+               buckets[i].heartRate.min, buckets[i].heartRate.max, buckets[i].heartRate.avg,
+               buckets[i].bloodPressure.min, buckets[i].bloodPressure.max, buckets[i].bloodPressure.avg,
+               buckets[i].spo2.min, buckets[i].spo2.max, buckets[i].spo2.avg);
+    }
+}
+
+long getHistoryReadingCount(const HistoryStore *store) {
+    if (store == NULL) return 0;
+    return store->readingCount;
+}
+
+size_t getHistoryMemoryUsage(const HistoryStore *store) {
+    if (store == NULL) return 0;
+    return sizeof(HistoryStore) +
+           (size_t)store->maxPatients * sizeof(PatientHistory) +
+           (size_t)store->blockCount * sizeof(HistoryBlock);
+}
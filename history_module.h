@@ -0,0 +1,68 @@
+#ifndef HISTORY_MODULE_H
+#define HISTORY_MODULE_H
+
+#include "input_module.h"
+
+#define HISTORY_BLOCK_BYTES 256
+
+/* Append-only block of compressed readings. The first reading is kept raw
+   in the header; the rest are bit-packed as delta-of-delta timestamps and
+   zigzag channel deltas. */
+typedef struct HistoryBlock {
+    struct HistoryBlock *next;
+    long startTime;
+    long endTime;
+    HealthReading first;
+    int count;
+    int bitLength;
+    unsigned char data[HISTORY_BLOCK_BYTES];
+} HistoryBlock;
+
+typedef struct {
+    HistoryBlock *head;
+    HistoryBlock *tail;
+    long lastTime;
+    long lastDelta;
+    HealthReading last;
+} PatientHistory;
+
+typedef struct {
+    PatientHistory *patients;
+    int maxPatients;
+    long retentionSeconds;
+    long blockCount;
+    long readingCount;
+} HistoryStore;
+
+typedef struct {
+    long timestamp;
+    HealthReading reading;
+} HistorySample;
+
+typedef struct {
+    int min;
+    int max;
+    double avg;
+} ChannelStats;
+
+typedef struct {
+    long startTime;
+    int count;
+    ChannelStats heartRate;
+    ChannelStats bloodPressure;
+    ChannelStats spo2;
+} HistoryBucket;
+
+HistoryStore* createHistoryStore(int maxPatients, long retentionSeconds);
+void destroyHistoryStore(HistoryStore *store);
+int appendHistory(HistoryStore *store, long timestamp, HealthReading reading);
+long expireHistoryStore(HistoryStore *store, long now);
+int queryHistoryRange(const HistoryStore *store, int patientId, long from, long to,
+                      HistorySample *samples, int maxSamples);
+int queryHistoryDownsampled(const HistoryStore *store, int patientId, long from, long to,
+                            long bucketSeconds, HistoryBucket *buckets, int maxBuckets);
+void displayHistoryBuckets(const HistoryBucket *buckets, int count);
+long getHistoryReadingCount(const HistoryStore *store);
+size_t getHistoryMemoryUsage(const HistoryStore *store);
+
+#endif
@@ -1,27 +1,76 @@
 #include "input_module.h"
 
+static int readDataLine(FILE *file, char *line, int size) {
+    do {
+        if (fgets(line, size, file) == NULL) {
+            return 0;
+        }
+    } while (line[strspn(line, " \t\r\n")] == '\0');   /* skip blank lines */
+    return 1;
+}
+
 int readHealthData(FILE *file, HealthReading *reading) {
     if (file == NULL || reading == NULL) {
         printf("Error: Invalid file or reading pointer\n");
         return 0;
     }
     
-    int result = fscanf(file, "%d,%d,%d", 
-                       &reading->heartRate, 
-                       &reading->bloodPressure, 
-                       &reading->spo2);
+    /* Lines are either "heartRate,bloodPressure,spo2" or
+       "patientId,heartRate,bloodPressure,spo2". */
+    char line[128];
+    if (!readDataLine(file, line, sizeof(line))) {
+        return 0;
+    }
     
-    if (result == 3) {
-        if (validateHealthReading(*reading)) {
-            return 1;
-        } else {
-            printf("Warning: Invalid health reading (HR:%d BP:%d SpO2:%d)\n",
-                   reading->heartRate, reading->bloodPressure, reading->spo2);
+    int fields[4];
+    int result = sscanf(line, "%d,%d,%d,%d", 
+                       &fields[0], &fields[1], &fields[2], &fields[3]);
+    
+    if (result == 4) {
+        if (fields[0] < 0 || fields[0] >= MAX_PATIENTS) {
+            printf("Warning: Invalid patient id %d (must be 0-%d)\n", 
+                   fields[0], MAX_PATIENTS - 1);
             return 0;
         }
+        reading->patientId = fields[0];
+        reading->heartRate = fields[1];
+        reading->bloodPressure = fields[2];
+        reading->spo2 = fields[3];
+    } else if (result == 3) {
+        reading->patientId = NO_PATIENT_ID;
+        reading->heartRate = fields[0];
+        reading->bloodPressure = fields[1];
+        reading->spo2 = fields[2];
+    } else {
+        return 0;
     }
     
-    return 0;
+    if (validateHealthReading(*reading)) {
+        return 1;
+    } else {
+        printf("Warning: Invalid health reading (HR:%d BP:%d SpO2:%d)\n",
+               reading->heartRate, reading->bloodPressure, reading->spo2);
+        return 0;
+    }
+}
+
+/* Returns the column count (3 or 4) of the first data line, or 0 if the
+   file has none, and rewinds the file. A file must use one format
+   throughout so generated ids never collide with explicit ones. */
+int detectInputFormat(FILE *file) {
+    if (file == NULL) {
+        return 0;
+    }
+    
+    char line[128];
+    int fields[4];
+    int result = 0;
+    if (readDataLine(file, line, sizeof(line))) {
+        result = sscanf(line, "%d,%d,%d,%d", 
+                       &fields[0], &fields[1], &fields[2], &fields[3]);
+    }
+    rewind(file);
+    return (result == 3 || result == 4) ? result : 0;
 }
 
 void displayHealthReading(HealthReading reading) {
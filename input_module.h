@@ -5,14 +5,19 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define NO_PATIENT_ID -1
+#define MAX_PATIENTS 1000     /* explicit patient ids must be below this */
+
 typedef struct {
+int patientId;
 int heartRate;
 int bloodPressure;
 int spo2;
 } HealthReading;
 
 int readHealthData(FILE *file, HealthReading *reading);
+int detectInputFormat(FILE *file);
 void displayHealthReading(HealthReading reading);
 int validateHealthReading(HealthReading reading);
 
-#endif
\ No newline at end of file
+#endif
@@ -1,15 +1,23 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include "input_module.h"
 #include "queue_module.h"
 #include "heap_module.h"
 #include "graph_module.h"
+#include "history_module.h"
+#include "alert_module.h"
+#include "checkpoint_module.h"
 
 #define INPUT_FILE "health_data.txt"
 #define QUEUE_CAPACITY 50
 #define HEAP_CAPACITY 50
 #define MAX_HOSPITALS 10
+#define HISTORY_RETENTION_SECONDS (24L * 60 * 60)
+#define HISTORY_SWEEP_SECONDS 60
+#define ALERT_QUEUE_CAPACITY 1024
+#define CHECKPOINT_PATH "careconnect_state"
 
 void setupHospitals(HospitalGraph *graph) {
     Hospital h1 = {0, "Max Hospital", "Dehradun"};
@@ -25,6 +33,18 @@ void setupHospitals(HospitalGraph *graph) {
     setDistance(graph, 1, 2, 280);
 }
 
+void dispatchEmergency(HospitalGraph *graph, AlertDispatcher *alerts, HealthReading reading) {
+    if (graph->numHospitals == 0) return;
+    
+    Hospital nearest;
+    AlertEvent alert;
+    findNearestHospital(graph, 0, &nearest, &alert.distance);
+    alert.reading = reading;
+    alert.priority = CRITICAL;
+    alert.hospitalId = nearest.id;
+    submitAlert(alerts, alert);
+}
+
 int main(void) {
     printf("\n========================================\n");
     printf("💙 CARECONNECT - ELDER HEALTH MONITORING\n");
@@ -40,14 +60,29 @@ int main(void) {
     }
     
     HealthQueue *queue = createQueue(QUEUE_CAPACITY);
-    PriorityHeap *heap = createHeap(HEAP_CAPACITY);
+    PriorityHeap *heap = createHeap(HEAP_CAPACITY, MAX_PATIENTS);
     HospitalGraph *graph = createGraph(MAX_HOSPITALS, MAX_HOSPITALS);
+    HistoryStore *history = createHistoryStore(MAX_PATIENTS, HISTORY_RETENTION_SECONDS);
+    AlertDispatcher *alerts = createAlertDispatcher(ALERT_SOCKET_PATH, ALERT_QUEUE_CAPACITY);
     
-    if (queue == NULL || heap == NULL || graph == NULL) {
+    if (queue == NULL || heap == NULL || graph == NULL || history == NULL || alerts == NULL) {
         printf("❌ Error: Failed to initialize data structures\n");
         return 1;
     }
     
+    /* Read before the checkpoint seeks the input: this rewinds the file */
+    int inputFormat = detectInputFormat(inputFile);
+    
+    Checkpointer *checkpoint = createCheckpointer(CHECKPOINT_PATH, queue, heap);
+    if (checkpoint == NULL) {
+        printf("❌ Error: Failed to initialize checkpointer\n");
+        return 1;
+    }
+    if (!attachCheckpointInput(checkpoint, inputFile)) {
+        /* Monitoring matters more than crash recovery: keep going */
+        printf("⚠️  Checkpointing unavailable, this run will not survive a crash\n");
+    }
+    
     setupHospitals(graph);
     
     printf("\n📊 STEP 1: READING HEALTH DATA FROM FILE...\n");
@@ -55,50 +90,112 @@ int main(void) {
     
     HealthReading reading;
     int readCount = 0;
+    int queueFull = 0;
+    int restoredCount = 0;
+    long lastSweep = (long)time(NULL);
+    
+    if (checkpoint->restored) {
+        readCount = checkpoint->readCount;
+        restoredCount = readCount;
+        printf("♻️  Resuming after %d readings (queue: %d, heap: %d)\n", 
+               readCount, getQueueSize(queue), getHeapSize(heap));
+    }
     
     while (readHealthData(inputFile, &reading)) {
-        if (enqueue(queue, reading)) {
-            printf("✅ Reading %d: HR=%3d | BP=%3d | SpO2=%3d%%\n", 
-                   readCount + 1, reading.heartRate, reading.bloodPressure, reading.spo2);
+        if ((reading.patientId == NO_PATIENT_ID) != (inputFormat == 3)) {
+            printf("⚠️  Mixed 3- and 4-column lines in %s! Stopping input.\n", INPUT_FILE);
+            break;
+        }
+        if (reading.patientId == NO_PATIENT_ID) {
+            if (readCount >= MAX_PATIENTS) {
+                printf("⚠️  More than %d readings without patient ids! Stopping input.\n", 
+                       MAX_PATIENTS);
+                break;
+            }
+            reading.patientId = readCount;
+        }
+        
+        if (checkpointEnqueue(checkpoint, reading, ftell(inputFile), readCount + 1)) {
+            printf("✅ Reading %d: Patient %d | HR=%3d | BP=%3d | SpO2=%3d%%\n", 
+                   readCount + 1, reading.patientId, 
+                   reading.heartRate, reading.bloodPressure, reading.spo2);
+            /* The input has no timestamp column, so history is keyed by
+               wall-clock ingest time. */
+            long now = (long)time(NULL);
+            appendHistory(history, now, reading);
+            if (now - lastSweep >= HISTORY_SWEEP_SECONDS) {
+                expireHistoryStore(history, now);
+                lastSweep = now;
+            }
             readCount++;
         } else {
             printf("⚠️  Queue full! Stopping input.\n");
+            queueFull = 1;
             break;
         }
     }
     
+    int inputComplete = feof(inputFile);
+    if (!inputComplete && !queueFull) {
+        /* Input stopped on a rejected line: count it as consumed so the
+           next run continues after it */
+        checkpointSkipInput(checkpoint, ftell(inputFile));
+    }
     fclose(inputFile);
-    printf("\n📈 Total readings loaded: %d\n\n", readCount);
+    printf("\n📈 Total readings loaded: %d\n\n", readCount - restoredCount);
     
     printf("🔄 STEP 2: TRANSFERRING QUEUE → PRIORITY HEAP...\n");
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
     
+    /* Restored heap entries were alerted when they were transferred, since
+       the alert goes out before the transfer is logged */
     int emergencyCount = 0;
-    while (!isQueueEmpty(queue)) {
-        HealthReading qReading;
-        if (dequeue(queue, &qReading)) {
-            if (insertReading(heap, qReading)) {
-                PriorityLevel priority = calculatePriority(qReading);
-                if (priority == CRITICAL) {
-                    emergencyCount++;
-                    printf("🚨 CRITICAL: HR=%3d | BP=%3d | SpO2=%3d%% [EMERGENCY!]\n", 
-                           qReading.heartRate, qReading.bloodPressure, qReading.spo2);
-                } else if (priority == WARNING) {
-                    printf("⚠️  WARNING: HR=%3d | BP=%3d | SpO2=%3d%%\n", 
-                           qReading.heartRate, qReading.bloodPressure, qReading.spo2);
-                } else {
-                    printf("✅ NORMAL : HR=%3d | BP=%3d | SpO2=%3d%%\n", 
-                           qReading.heartRate, qReading.bloodPressure, qReading.spo2);
-                }
-            }
+    for (int i = 0; i < getHeapSize(heap); i++) {
+        if (heap->heap[i].priority == CRITICAL) {
+            HealthReading restored = heap->heap[i].reading;
+            emergencyCount++;
+            printf("🚨 CRITICAL: HR=%3d | BP=%3d | SpO2=%3d%% [RESTORED]\n", 
+                   restored.heartRate, restored.bloodPressure, restored.spo2);
         }
     }
     
+    HealthReading qReading;
+    while (peekQueue(queue, &qReading)) {
+        /* Triage and alert before the transfer is logged: a crash in
+           between re-alerts on restart instead of losing the alert. A full
+           heap must not swallow an emergency either. */
+        PriorityLevel priority = calculatePriority(qReading);
+        if (priority == CRITICAL) {
+            emergencyCount++;
+            printf("🚨 CRITICAL: HR=%3d | BP=%3d | SpO2=%3d%% [EMERGENCY!]\n", 
+                   qReading.heartRate, qReading.bloodPressure, qReading.spo2);
+            dispatchEmergency(graph, alerts, qReading);
+        } else if (priority == WARNING) {
+            printf("⚠️  WARNING: HR=%3d | BP=%3d | SpO2=%3d%%\n", 
+                   qReading.heartRate, qReading.bloodPressure, qReading.spo2);
+        } else {
+            printf("✅ NORMAL : HR=%3d | BP=%3d | SpO2=%3d%%\n", 
+                   qReading.heartRate, qReading.bloodPressure, qReading.spo2);
+        }
+        checkpointTransfer(checkpoint, &qReading);
+    }
+    
     printf("\n📋 STEP 3: PRIORITY HEAP ANALYSIS...\n");
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
     printf("Heap Size: %d\n\n", getHeapSize(heap));
     displayHeap(heap);
     
+    if (!isHeapEmpty(heap)) {
+        int topPatient = heap->heap[0].reading.patientId;
+        long now = (long)time(NULL);
+        HistoryBucket buckets[24];
+        int bucketCount = queryHistoryDownsampled(history, topPatient, 
+                                                  now - HISTORY_RETENTION_SECONDS, now, 
+                                                  60 * 60, buckets, 24);
+        printf("\n🕒 Last 24h for top-priority patient %d (hourly):\n", topPatient);
+        displayHistoryBuckets(buckets, bucketCount);
+    }
+    
     printf("\n🏥 STEP 4: HOSPITAL ROUTING...\n");
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
     displayHospitals(graph);
@@ -117,14 +214,25 @@ int main(void) {
     
     printf("\n📊 FINAL SUMMARY\n");
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
-    printf("Total Readings: %d\n", readCount);
+    printf("Total Readings: %d\n", readCount - restoredCount);
+    if (restoredCount > 0) {
+        printf("Restored Readings: %d\n", restoredCount);
+    }
     printf("Emergencies Detected: %d\n", emergencyCount);
     printf("Heap Capacity: %d/%d\n", getHeapSize(heap), getHeapCapacity(heap));
+    printf("History Stored: %ld readings (%lu bytes)\n", 
+           getHistoryReadingCount(history), (unsigned long)getHistoryMemoryUsage(history));
     printf("\n✅ CARECONNECT SYSTEM RUNNING SUCCESSFULLY!\n\n");
     
+    destroyAlertDispatcher(alerts);
+    if (inputComplete) {
+        finishCheckpoint(checkpoint);
+    }
+    destroyCheckpointer(checkpoint);
     destroyQueue(queue);
     destroyHeap(heap);
     destroyGraph(graph);
+    destroyHistoryStore(history);
     
     return 0;
 }
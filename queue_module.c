@@ -83,6 +83,20 @@ int dequeue(HealthQueue *queue, HealthReading *reading) {
     return 1;
 }
 
+int peekQueue(const HealthQueue *queue, HealthReading *reading) {
+    if (queue == NULL || reading == NULL) {
+        printf("Error: Invalid queue or reading pointer\n");
+        return 0;
+    }
+    
+    if (isQueueEmpty(queue)) {
+        return 0;
+    }
+    
+    *reading = queue->data[queue->front];
+    return 1;
+}
+
 void displayQueue(const HealthQueue *queue) {
     if (queue == NULL || isQueueEmpty(queue)) {
         printf("[Queue] Empty\n");
@@ -15,6 +15,7 @@ HealthQueue* createQueue(int capacity);
 void destroyQueue(HealthQueue *queue);
 int enqueue(HealthQueue *queue, HealthReading reading);
 int dequeue(HealthQueue *queue, HealthReading *reading);
+int peekQueue(const HealthQueue *queue, HealthReading *reading);
 int isQueueEmpty(const HealthQueue *queue);
 int isQueueFull(const HealthQueue *queue);
 void displayQueue(const HealthQueue *queue);